@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h> 
 #include <string.h>
+#include <ctype.h>
+#include <unistd.h>
 #include "errno.h" 
 #include "Category.h" 
 
@@ -14,7 +16,10 @@
                     "\n W.A.Y.S. - What Are You Spending? "\
                     "\n======================================================"
 #define USAGE "Usage: ./budget.exe [file_name]" \
-              "\n\t file_name: the filename of an existing budget report"
+              "\n       ./budget.exe --diff old_file new_file" \
+              "\n       ./budget.exe --mem [file_name]" \
+              "\n\t file_name: the filename of an existing budget report" \
+              "\n\t old_file, new_file: two budget reports to compare"
 #define PROMPT "Type in a number option to take action:" \
                "\n\t 1) Add spending category" \
                "\n\t 2) Add amount spent to spending category" \
@@ -39,6 +44,7 @@
 #define OVER_LIMIT "Error: %s is too long. (%d max character limit)\n\n"
 #define NO_PRINT "Error: no data to show\n\n" 
 #define NO_MEM "Error: no more memory\n\n" 
+#define NO_EXPORT "Error: cannot write to %s\n\n"
 #define BAD_FILE "Error: cannot read file\n\n" 
 
 #define FILE_IMPORTED "Success! %s imported\n\n" 
@@ -47,22 +53,88 @@
 #define FORMAT_HEADER "Budget Report for %s"  // Header for report
 #define FORMAT_CATEGORY "%-30s$%-16.2f%-4.2f%%\n" // Lists spending category
 #define FORMAT_TOTAL "%-30s$%-16.2f\n"              // Lists total spending
+#define FORMAT_DIFF_HEADER "Comparing %s to %s\n\n" // Header for comparison
+#define FORMAT_DIFF_COLUMNS "%-30s%-13s%-13s%-13s%s\n" // Comparison columns
+#define FORMAT_DIFF "%-30s$%-11.2f $%-11.2f %+-12.2f %s\n" // Lists one change
+#define FORMAT_PERCENT "%+.2f%%"                      // Percentage change
+#define DIFF_ADDED "ADDED"
+#define DIFF_REMOVED "REMOVED"
+#define DIFF_NO_PERCENT "--"
+#define FORMAT_MEM_HEADER "Memory used by %s\n\n"    // Header for memory use
+#define FORMAT_MEM "%-30s%zu\n"                      // Lists a byte count
+#define FORMAT_MEM_AVG "%-30s%.2f\n"                 // Lists bytes per category
+#define FORMAT_MEM_PROJECTED "BYTES FOR %d CATEGORIES"
+#define MEM_NO_FILE "empty report"
 
 #define BASE 10                     // Base conversion for strtol
 #define NOFILE_ARG 1                // Flag if there is no file to scan
 #define FILE_ARG 2                  // Flag if there is a file to scan 
-#define MAX_CATEGORIES 20           // Max number of categories allowed
+#define MAX_NAME 20                 // Max number of characters in a name
 #define MIN_OPTION 1                // First option given in prompt
 #define MAX_OPTION 7                // Last option given in prompt
 #define FORMAT_CATEGORY_WIDTH 30    // Format width for category name
 #define FORMAT_MONEY_WIDTH 16       // Format width for amount spent
 #define FORMAT_PERCENT_WIDTH 4      // Format width for percentage of total
+#define PERCENT_SIZE 32             // Buffer size for a formatted percentage
+#define DIFF_ARG "--diff"           // Flag to compare two reports
+#define DIFF_ARGC 4                 // Number of args with --diff old new
+#define MEM_ARG "--mem"             // Flag to report memory used by a report
+#define MEM_ARGC 3                  // Number of args with --mem file
+#define MEM_PROJECTION 1000000      // Categories to project memory use for
+#define LABEL_SIZE 64               // Buffer size for a formatted label
+#define STORE_INIT_SIZE 16          // Records allocated for a new store
+#define EMPTY_SLOT -1               // Marks an unused hash slot
+#define FNV_OFFSET 2166136261u      // FNV-1a hash starting value
+#define FNV_PRIME 16777619u         // FNV-1a hash multiplier
+#define READ_AHEAD 65536            // Bytes of piped input buffered per read
 
 #define FILE_WRITE "w"
 #define FILE_READ "r" 
 
-struct Category *findCategory( int numCat, char *categoryName, 
-                               struct Category *catArr[] );
+/**
+ * Read-ahead buffer for stdin when commands are piped in rather than typed
+ */
+static char readAhead[READ_AHEAD];
+
+int storeInit( struct CategoryStore *store );
+void storeFree( struct CategoryStore *store );
+const char *storeName( struct CategoryStore *store, int index );
+int storeFind( struct CategoryStore *store, const char *name );
+int storeAdd( struct CategoryStore *store, const char *name, float amount );
+void storeRemove( struct CategoryStore *store, int index );
+
+/**
+ * Function: readLine( char *line, FILE *stream ) 
+ * Parameters: line - reusable buffer of BUFSIZ bytes to read into
+ *             stream - where the line should be read from
+ * Description: reads one line into the buffer and removes its newline
+ *              character. Anything past BUFSIZ is thrown away so that an
+ *              overlong line is not picked up as the next command 
+ * Return: 0 if a line was read, -1 at end of input
+ * Error Conditions: none
+ */
+int readLine( char *line, FILE *stream ) {
+  char *newlineChar; 
+  int c;
+
+  if( fgets( line, BUFSIZ, stream ) == NULL ) {
+    return -1;
+  }
+
+  // replace newline character with null-terminating character, or skip the
+  // rest of the line if it did not fit
+  newlineChar = strchr( line, (int) '\n' ); 
+  if( newlineChar != NULL ) {
+    *newlineChar = '\0';
+  } else {
+    do {
+      c = getc( stream );
+    } while( c != '\n' && c != EOF );
+  }
+
+  return 0;
+}
+
 /**
  * Function: usage( int argc ) 
  * Parameters: argc - the number of arguments passed into the program
@@ -111,11 +183,6 @@ int usage( int argc, char* argv[], FILE **budgetAcct ) {
 int validate_options( const char *strInput ) {
  
   char *endptr; 
-  char *newlineChar; 
-
-  // replace newline character with null-terminating character
-  newlineChar = memchr( strInput, (int) '\n', BUFSIZ ); 
-  *newlineChar = '\0';
 
   // convert string input into int 
   int input = (int) strtol( strInput, &endptr, BASE ); 
@@ -129,54 +196,46 @@ int validate_options( const char *strInput ) {
 }
 
 /**
- * Function: addCategory() 
- * Parameters: numCategories - the number of categories in this spending report
- *             catArray - the array of struct Categories 
- * Description: adds category to array and updates spending report 
- * Return: 0 if successful, -1 if name invalid, -2 if no more memory 
- * Error condition: name of category is 0 or over 20 characters 
+ * Function: addCategory( struct CategoryStore *store, char *line ) 
+ * Parameters: store - the categories in this spending report
+ *             line - reusable input buffer to read the name into
+ * Description: adds category to store and updates spending report 
+ * Return: index of the new category if successful, -1 if not
+ * Error condition: name of category is 0 or over 20 characters, no more
+ *                  memory 
  */ 
-struct Category *addCategory( int numCategories, struct Category *catArray[] ) {
-  char *categoryName = malloc( BUFSIZ );
-  char *newlineChar; 
+int addCategory( struct CategoryStore *store, char *line ) {
+  size_t nameLen;
+  int index;
 
   // prompt user 
   fprintf( stdout, "%s", NEW_CATEGORY ); 
 
   // get new category name 
-  fgets( categoryName, BUFSIZ, stdin );
-
-  // check length of name
-  if( strlen( categoryName ) < 1 || strlen( categoryName ) > MAX_CATEGORIES ) {
-    fprintf( stdout, OVER_LIMIT, "Category name", MAX_CATEGORIES ); 
-    return NULL; 
+  if( readLine( line, stdin ) != 0 ) {
+    return -1;
   }
 
-  // create new category  
-  struct Category *newCategory = malloc( sizeof(struct Category) ); 
-
-  // return -1 if no more memory 
-  if( newCategory == NULL ) { 
-    fprintf( stdout, NO_MEM ); 
-    return NULL; 
+  // check length of name
+  nameLen = strlen( line );
+  if( nameLen < 1 || nameLen > MAX_NAME ) {
+    fprintf( stdout, OVER_LIMIT, "Category name", MAX_NAME ); 
+    return -1; 
   }
 
-  // replaces newline character in category name with null terminating character
-  newlineChar = memchr( categoryName, (int) '\n', BUFSIZ ); 
-  *newlineChar = '\0';
-
   // convert name to all caps
   int i;
-  for( i = 0; i < strlen( categoryName ); i++ ) {
-    categoryName[i] = toupper( categoryName[i] ); 
+  for( i = 0; i < nameLen; i++ ) {
+    line[i] = toupper( line[i] ); 
   } 
 
-  // put name information in new struct, then put it in array of structs
-  newCategory->name = categoryName; 
-  newCategory->amount = 0;
-  catArray[numCategories] = newCategory; 
+  // copy name into the store
+  index = storeAdd( store, line, 0 );
+  if( index == -1 ) { 
+    fprintf( stdout, NO_MEM ); 
+  }
 
-  return newCategory; 
+  return index; 
 }
 
 /**
@@ -196,54 +255,51 @@ float convertCents( float cents ) {
 } 
 
 /**
- * Function: alterAmount( float *total, int dollars, float cents, struct
- * Category *category )
+ * Function: alterAmount( float *total, int dollars, float cents, 
+ *                        float *amount )
  * Parameters: total - pointer to the running total 
  *             dollars - int amount of dollars to add/subtract
  *             cents - float amount of cents to add/subtract
- *             category - category to add 
+ *             amount - amount spent in the category to add to
  * Description: alters amount to an existing category 
  * Return: void 
  * Error Conditions: none 
  */ 
-int alterAmount( float *total, int dollars, float cents, struct Category
-    *category ) {
+int alterAmount( float *total, int dollars, float cents, float *amount ) {
   // add to category amount and running total 
-  category->amount = category->amount + (float) dollars + convertCents( cents );
+  *amount = *amount + (float) dollars + convertCents( cents );
   *total = *total + (float) dollars + convertCents( cents ); 
 
   return 0;
 }
 
 /**
- * Function: askAmount( int *total, struct Category *category, int mode ) 
- * Parameters: category - the category to add money into 
+ * Function: askAmount( float *total, float *amount, int mode,
+ *                      char *amountStr ) 
+ * Parameters: amount - amount spent in the category to add money into 
  *             total - addy to total spending budget
  *             mode - 0 for add amount, 1 for subtract amount
+ *             amountStr - reusable input buffer to read the amount into
  * Description: prompts user and adds spending amount to a 
  *              specified spending category 
  * Return: 0 if successful, -1 if not 
  * Error Conditions: if the amount entered is not a number
  */
-int askAmount( float *total, struct Category *category, int mode ) { 
+int askAmount( float *total, float *amount, int mode, char *amountStr ) { 
   char *endPtr; 
-  char *newlineChar;
   char *decimal;
-  char *amountStr = malloc( BUFSIZ ); 
   int dollars; 
   float cents = 0; 
 
-  fgets( amountStr, BUFSIZ, stdin ); 
-
-  // remove newline character
-  newlineChar = memchr( amountStr, (int) '\n', BUFSIZ ); 
-  *newlineChar = '\0';
+  if( readLine( amountStr, stdin ) != 0 ) {
+    return -1;
+  }
 
   // checks if there is a decimal point
-  if( memchr( amountStr, (int) '.', BUFSIZ ) != NULL ) {
+  decimal = strchr( amountStr, (int) '.' ); 
+  if( decimal != NULL ) {
 
     // replace decimal with null terminator 
-    decimal = memchr( amountStr, (int) '.', BUFSIZ ); 
     *decimal = '\0'; 
 
     // read dollars, check for error
@@ -271,105 +327,77 @@ int askAmount( float *total, struct Category *category, int mode ) {
 
   // either adds or subtracts amount from category depending on mode 
   if( mode == 0 ) { 
-    alterAmount( total, dollars, cents, category ); 
+    alterAmount( total, dollars, cents, amount ); 
   } else {
 
     // turn into negative versions of dollars and cents
     dollars = 0 - dollars; 
     cents = 0 - cents; 
-    alterAmount( total, dollars, cents, category ); 
+    alterAmount( total, dollars, cents, amount ); 
   }
 
-  free( amountStr ); 
   return 0; 
 }
 
 /**
- * Function: findCategory( int numCat, char *categoryName,
- *                         struct Category *catArr[] ) 
- * Parameters: numCat - the number of category entries in the array  
- *             categoryName - the name of the category to find
- *             catArr - the array of categories 
- * Description: returns the category found from the category array
- * Return: pointer to Category if found, NULL if not found
+ * Function: findCategory( struct CategoryStore *store, char *categoryName ) 
+ * Parameters: store - the categories in this spending report
+ *             categoryName - the name of the category to find, without
+ *                            its newline character
+ * Description: returns the category found from the store
+ * Return: index of the category if found, -1 if not found
  * Error Conditions: None
  */ 
-struct Category *findCategory( int numCat, char *categoryName, 
-                               struct Category *catArr[] ) {
+int findCategory( struct CategoryStore *store, char *categoryName ) {
   int i;
-  char *newlineChar; 
-
-  // don't search if there are 0 categories
-  if( numCat == 0 ) { 
-    return NULL;
-  }
-
-  // replace newline character with null terminating character 
-  newlineChar = memchr( categoryName, (int) '\n', BUFSIZ ); 
-  *newlineChar = '\0'; 
 
   // convert input to all caps
   for( i = 0; i < strlen(categoryName); i++ ) {
     categoryName[i] = toupper( categoryName[i] ); 
   } 
 
-  // search for equals 
-  for( i = 0; i < numCat; i++ ) {
-    if( strncmp( catArr[i]->name, categoryName, MAX_CATEGORIES ) == 0 ) {
-      return catArr[i];
-    }
-  }
-
-  return NULL; 
+  return storeFind( store, categoryName ); 
 }
 
 /**
- * Function: removeCategory( struct Category *remCategory, struct Category
- * *catArr[], int numCategories ) 
- * Parameters: remCategory - the category to remove from array
- *             catArr - array of categories 
- *             numCategories - number of total categories 
+ * Function: removeCategory( struct CategoryStore *store, int index,
+ *                           float *total ) 
+ * Parameters: store - the categories in this spending report
+ *             index - index of the category to remove
  *             total - total amount of money spent
- * Description: removes category from array of categories
+ * Description: removes category from the store of categories
  * Return: void
  * Error Conditions: none
  */
-void removeCategory( struct Category *remCategory, struct Category *catArr[],
-                     int *numCategories, float *total ) { 
+void removeCategory( struct CategoryStore *store, int index, float *total ) { 
+
   // subtract amount recorded in category from recorded total 
-  *total = *total - remCategory->amount; 
-  
-  // replace category to remove with last category
-  remCategory->name = catArr[*numCategories - 1]->name; 
-  remCategory->amount = catArr[*numCategories - 1]->amount; 
+  *total = *total - store->amounts[index]; 
 
-  // decrease num of categories
-  (*numCategories)--; 
+  storeRemove( store, index ); 
 }
 
 /** 
- * Function: printData( int numCategories, int total, struct Category 
- *                      *catArr[], FILE *stream ) 
- * Parameters: numCategories - total number of categories recorded 
+ * Function: printData( struct CategoryStore *store, float total,
+ *                      FILE *stream ) 
+ * Parameters: store - the categories in this spending report
  *             total - total amount of money spent
- *             catArr - the array of categories
  *             stream - where the report should be outputted
  * Description: prints out the category data in a legible manner to the stream
  *              specified
  * Return: void
  * Error Conditions: none
  */ 
-void printData( int numCategories, float total, struct Category *catArr[], 
-                FILE *stream ) {
+void printData( struct CategoryStore *store, float total, FILE *stream ) {
   int i;
 
   // beginning separator
   fprintf( stream, "%s%s", "\n", FORMAT_SEP ); 
 
   // prints each category and its respective statistics
-  for( i = 0; i < numCategories; i++ ) {
-    fprintf( stream, FORMAT_CATEGORY, catArr[i]->name,
-        catArr[i]->amount, ((catArr[i]->amount/total) * 100)); 
+  for( i = 0; i < store->count; i++ ) {
+    fprintf( stream, FORMAT_CATEGORY, storeName( store, i ),
+        store->amounts[i], ((store->amounts[i]/total) * 100)); 
   }
 
   // newline buffer between categories and total
@@ -383,141 +411,902 @@ void printData( int numCategories, float total, struct Category *catArr[],
 }
 
 /**
- * Function: readFile( float *runningTotal, FILE *exisFile, struct Category
- * *catArr[] ) 
- * Parameters: exisFile - existing file that needs to be read 
- *             runningTotal - pointer to the running total  
- *             catArr - array of Categories to record information
- * Description: reads and records data into categories
- * Return: 0 if successful, 1 if not 
- * Error Conditions: if file is unable to be read, not in correct format
+ * Function: readHeader( FILE *report, char *line ) 
+ * Parameters: report - budget report being read
+ *             line - reusable buffer to read each line of the report into
+ * Description: reads the newline and separator that begin every report
+ * Return: 0 if successful, -1 if not
+ * Error Conditions: report does not begin with a newline and separator
  */
-int readFile( int *categoryCount, float *runningTotal, FILE *exisFile, 
-              struct Category *catArr[] ) { 
-  char *newLine; 
-  char *separator; 
-  char *category; 
+int readHeader( FILE *report, char *line ) {
 
   // grab newline from report 
-  newLine = malloc( BUFSIZ ); 
-  fgets( newLine, BUFSIZ, exisFile ); 
-  if( strncmp( newLine, "\n", BUFSIZ ) != 0 ) {
+  if( readLine( line, report ) != 0 || line[0] != '\0' ) {
+    return -1;
+  }
+
+  // grab separator, which is stored without its newline character
+  if( readLine( line, report ) != 0 || 
+      strlen( line ) != strlen( FORMAT_SEP ) - 1 ||
+      strncmp( line, FORMAT_SEP, strlen( line ) ) != 0 ) {
+    return -1; 
+  }
+
+  return 0;
+}
+
+/**
+ * Function: hashName( const char *name ) 
+ * Parameters: name - category name to hash
+ * Description: computes the FNV-1a hash of a category name
+ * Return: the hash of the name
+ * Error Conditions: none
+ */
+unsigned int hashName( const char *name ) {
+  unsigned int hash = FNV_OFFSET;
+
+  while( *name != '\0' ) {
+    hash = (hash ^ (unsigned char) *name) * FNV_PRIME;
+    name++;
+  }
+
+  return hash;
+}
+
+/**
+ * Function: storeIndex( struct CategoryStore *store ) 
+ * Parameters: store - store whose hash index should be rebuilt
+ * Description: resizes the hash index to twice the record capacity and
+ *              re-inserts every record, keeping the index at most half full
+ * Return: 0 if successful, -1 if not
+ * Error Conditions: no more memory
+ */
+int storeIndex( struct CategoryStore *store ) {
+  int numSlots = store->capacity * 2;
+  int *slots = malloc( numSlots * sizeof(int) );
+  int i;
+  int slot;
+
+  if( slots == NULL ) {
+    return -1;
+  }
+
+  for( i = 0; i < numSlots; i++ ) {
+    slots[i] = EMPTY_SLOT;
+  }
+
+  // probe linearly from each record's hash to the first empty slot
+  for( i = 0; i < store->count; i++ ) {
+    slot = store->hashes[i] & (numSlots - 1);
+    while( slots[slot] != EMPTY_SLOT ) {
+      slot = (slot + 1) & (numSlots - 1);
+    }
+    slots[slot] = i;
+  }
 
-    free( newLine );
+  free( store->slots );
+  store->slots = slots;
+  store->numSlots = numSlots;
 
+  return 0;
+}
+
+/**
+ * Function: storeInit( struct CategoryStore *store ) 
+ * Parameters: store - store to set up
+ * Description: allocates an empty store of categories
+ * Return: 0 if successful, -1 if not
+ * Error Conditions: no more memory
+ */
+int storeInit( struct CategoryStore *store ) {
+  store->count = 0;
+  store->capacity = STORE_INIT_SIZE;
+  store->slots = NULL;
+  store->numSlots = 0;
+  store->names = malloc( STORE_INIT_SIZE * sizeof(union CategoryName) );
+  store->amounts = malloc( STORE_INIT_SIZE * sizeof(float) );
+  store->hashes = malloc( STORE_INIT_SIZE * sizeof(unsigned int) );
+
+  if( store->names == NULL || store->amounts == NULL || 
+      store->hashes == NULL || storeIndex( store ) != 0 ) {
+    storeFree( store );
     return -1;
   }
 
-  // grab separator
-  separator = malloc( BUFSIZ ); 
-  fgets( separator, BUFSIZ, exisFile ); 
-  if( strncmp( separator, FORMAT_SEP, BUFSIZ ) != 0 ) {
+  return 0;
+}
 
-    free( newLine ); 
-    free( separator ); 
+/**
+ * Function: setName( union CategoryName *slot, const char *name ) 
+ * Parameters: slot - record to hold the name
+ *             name - category name to copy
+ * Description: copies a name into the record, spilling it to the heap only
+ *              if it is longer than NAME_INLINE characters
+ * Return: 0 if successful, -1 if not
+ * Error Conditions: no more memory
+ */
+int setName( union CategoryName *slot, const char *name ) {
+  size_t length = strlen( name );
+  char *copy;
 
-    return -1; 
+  // strncpy zero pads, so the last byte is left as the terminator
+  if( length <= NAME_INLINE ) {
+    strncpy( slot->text, name, NAME_INLINE + 1 );
+    return 0;
   }
 
-  // free newline and separator 
-  free( newLine );
-  free( separator ); 
+  copy = malloc( length + 1 );
+  if( copy == NULL ) {
+    return -1;
+  }
+  strcpy( copy, name );
+  slot->heap = copy;
+  slot->text[NAME_INLINE] = NAME_LONG;
 
-  // loop through categories specified and record them into array
-  category = malloc( BUFSIZ ); 
-  fgets( category, BUFSIZ, exisFile ); 
-  while( strncmp( category, "\n", BUFSIZ ) != 0 ) { 
-    
-    // keep track of temporary information 
-    struct Category *newCategory; 
-    char *catName = malloc( BUFSIZ ); 
-    strncpy( catName, strtok(category, " "), BUFSIZ ); 
-    //catName = strtok( category, " " ); 
-    char *amountStr = malloc( BUFSIZ );
-    amountStr = strtok( NULL, " " ); 
-
-    char *decimal; 
-    char *endPtr; 
-    int dollars = 0; 
-    float cents = 0; 
-
-    // allocate space for new category and record category name
-    if( catName != NULL ) {
-      newCategory = malloc( sizeof(struct Category) ); 
-      newCategory->name = catName; 
-      catArr[*categoryCount] = newCategory; 
-
-    } else { 
-      free( catName ); 
-      free( amountStr ); 
-      
-      return -1; 
+  return 0;
+}
+
+/**
+ * Function: freeName( union CategoryName *slot ) 
+ * Parameters: slot - record holding the name
+ * Description: frees the heap copy of a long name
+ * Return: void
+ * Error Conditions: none
+ */
+void freeName( union CategoryName *slot ) {
+  if( slot->text[NAME_INLINE] == NAME_LONG ) {
+    free( slot->heap );
+  }
+}
+
+/**
+ * Function: storeName( struct CategoryStore *store, int index ) 
+ * Parameters: store - store holding the category
+ *             index - index of the category
+ * Description: finds where the name of a category is kept
+ * Return: the name of the category
+ * Error Conditions: none
+ */
+const char *storeName( struct CategoryStore *store, int index ) {
+  union CategoryName *name = &store->names[index];
+
+  return name->text[NAME_INLINE] == NAME_LONG ? name->heap : name->text;
+}
+
+/**
+ * Function: storeFree( struct CategoryStore *store ) 
+ * Parameters: store - store to release
+ * Description: frees every long category name along with the store's arrays
+ * Return: void
+ * Error Conditions: none
+ */
+void storeFree( struct CategoryStore *store ) {
+  int i;
+
+  for( i = 0; i < store->count; i++ ) {
+    freeName( &store->names[i] );
+  }
+
+  free( store->names );
+  free( store->amounts );
+  free( store->hashes );
+  free( store->slots );
+  store->names = NULL;
+  store->amounts = NULL;
+  store->hashes = NULL;
+  store->slots = NULL;
+  store->count = 0;
+}
+
+/**
+ * Function: storeFind( struct CategoryStore *store, const char *name ) 
+ * Parameters: store - store to search
+ *             name - name of the category to find
+ * Description: looks up a category through the store's hash index, only
+ *              comparing names whose hashes already match
+ * Return: index of the record if found, -1 if not
+ * Error Conditions: none
+ */
+int storeFind( struct CategoryStore *store, const char *name ) {
+  unsigned int hash = hashName( name );
+  int slot = hash & (store->numSlots - 1);
+  int index;
+
+  while( (index = store->slots[slot]) != EMPTY_SLOT ) {
+    if( store->hashes[index] == hash && 
+        strcmp( storeName( store, index ), name ) == 0 ) {
+      return index;
     }
+    slot = (slot + 1) & (store->numSlots - 1);
+  }
 
-    // remove dollar sign and convert to dollars and cents
-    if( amountStr != NULL ) {
-      amountStr++; 
-      
-      // replace decimal with null terminator 
-      decimal = memchr( amountStr, (int) '.', BUFSIZ ); 
-      *decimal = '\0'; 
-
-      
-      // read dollars, check for error
-      dollars = (int) strtol( amountStr, &endPtr, BASE ); 
-      if( *endPtr != '\0' ) {
-        fprintf( stdout, NO_LONG, amountStr ); 
-        return -1;
-      }
-      
-      // read cents, check for error
-      endPtr = endPtr + 1; 
-      cents = strtol( endPtr, &endPtr, BASE );
-      if( *endPtr != '\0' ) {
-        fprintf( stdout, NO_LONG, amountStr ); 
-        return -1; 
-      } 
+  return -1;
+}
+
+/**
+ * Function: storeGrow( struct CategoryStore *store ) 
+ * Parameters: store - store that has run out of records
+ * Description: doubles the number of records allocated; the hash index is
+ *              rebuilt by the caller once the new record is in place
+ * Return: 0 if successful, -1 if not
+ * Error Conditions: no more memory
+ */
+int storeGrow( struct CategoryStore *store ) {
+  int capacity = 2 * store->capacity;
+  union CategoryName *names;
+  float *amounts;
+  unsigned int *hashes;
+
+  names = realloc( store->names, capacity * sizeof(union CategoryName) );
+  if( names == NULL ) {
+    return -1;
+  }
+  store->names = names;
 
-      // record amount into array
-      alterAmount( runningTotal, dollars, cents, catArr[*categoryCount] );
+  amounts = realloc( store->amounts, capacity * sizeof(float) );
+  if( amounts == NULL ) {
+    return -1;
+  }
+  store->amounts = amounts;
 
-      // increment category count
-      (*categoryCount)++; 
+  hashes = realloc( store->hashes, capacity * sizeof(unsigned int) );
+  if( hashes == NULL ) {
+    return -1;
+  }
+  store->hashes = hashes;
 
-    } else {
-      free( catName ); 
-      free( amountStr ); 
-      free( newCategory ); 
+  store->capacity = capacity;
+  return 0;
+}
 
+/**
+ * Function: storeAdd( struct CategoryStore *store, const char *name,
+ *                     float amount ) 
+ * Parameters: store - store to add to
+ *             name - name of the category
+ *             amount - amount spent in the category
+ * Description: records the amount under the category, adding the category
+ *              if the store does not have it yet
+ * Return: index of the record if successful, -1 if not
+ * Error Conditions: no more memory
+ */
+int storeAdd( struct CategoryStore *store, const char *name, float amount ) {
+  unsigned int hash = hashName( name );
+  int slot = hash & (store->numSlots - 1);
+  int index;
+
+  // category already recorded, so just add to it
+  while( (index = store->slots[slot]) != EMPTY_SLOT ) {
+    if( store->hashes[index] == hash && 
+        strcmp( storeName( store, index ), name ) == 0 ) {
+      store->amounts[index] += amount;
+      return index;
+    }
+    slot = (slot + 1) & (store->numSlots - 1);
+  }
+
+  if( store->count == store->capacity && storeGrow( store ) != 0 ) {
+    return -1;
+  }
+
+  index = store->count;
+  if( setName( &store->names[index], name ) != 0 ) {
+    return -1;
+  }
+  store->amounts[index] = amount;
+  store->hashes[index] = hash;
+  store->count++;
+
+  // rebuild the index after growing, otherwise use the empty slot found above
+  if( store->numSlots < store->capacity * 2 ) {
+    if( storeIndex( store ) != 0 ) {
+      store->count--;
+      freeName( &store->names[index] );
       return -1;
     }
-    
-    // save next line in string category 
-    fgets( category, BUFSIZ, exisFile ); 
-    free( amountStr ); 
+  } else {
+    store->slots[slot] = index;
   }
 
-  free( category ); 
+  return index;
+}
 
-  return 0;
+/**
+ * Function: storeSlot( struct CategoryStore *store, int index ) 
+ * Parameters: store - store holding the category
+ *             index - index of the category
+ * Description: finds the hash slot that refers to a record
+ * Return: the slot holding index
+ * Error Conditions: none
+ */
+int storeSlot( struct CategoryStore *store, int index ) {
+  int slot = store->hashes[index] & (store->numSlots - 1);
+
+  while( store->slots[slot] != index ) {
+    slot = (slot + 1) & (store->numSlots - 1);
+  }
+
+  return slot;
+}
+
+/**
+ * Function: storeRemove( struct CategoryStore *store, int index ) 
+ * Parameters: store - store holding the category
+ *             index - index of the category to remove
+ * Description: removes a category, moving the last record into its place
+ * Return: void
+ * Error Conditions: none
+ */
+void storeRemove( struct CategoryStore *store, int index ) {
+  int mask = store->numSlots - 1;
+  int last = store->count - 1;
+  int hole = storeSlot( store, index );
+  int slot = hole;
+  int home;
+
+  freeName( &store->names[index] );
+
+  // shift later entries of the probe run back over the hole, skipping any
+  // whose home slot lies between the hole and where they sit
+  for( slot = (slot + 1) & mask; store->slots[slot] != EMPTY_SLOT; 
+       slot = (slot + 1) & mask ) {
+    home = store->hashes[store->slots[slot]] & mask;
+    if( ((slot - home) & mask) >= ((slot - hole) & mask) ) {
+      store->slots[hole] = store->slots[slot];
+      hole = slot;
+    }
+  }
+  store->slots[hole] = EMPTY_SLOT;
+
+  // fill the gap in the records with the last one
+  if( index != last ) {
+    store->names[index] = store->names[last];
+    store->amounts[index] = store->amounts[last];
+    store->hashes[index] = store->hashes[last];
+    store->slots[storeSlot( store, last )] = index;
+  }
+
+  store->count--;
+}
+
+/**
+ * Function: storeBytes( int capacity ) 
+ * Parameters: capacity - number of records allocated
+ * Description: computes the bytes a store's records and hash index take up,
+ *              not counting names too long to keep inline
+ * Return: the number of bytes
+ * Error Conditions: none
+ */
+size_t storeBytes( int capacity ) {
+  size_t recordBytes = sizeof(union CategoryName) + sizeof(float) + 
+                       sizeof(unsigned int);
+
+  return (size_t) capacity * recordBytes + 
+         (size_t) capacity * 2 * sizeof(int);
+}
+
+/**
+ * Function: readCategoryLine( FILE *report, char *line, char **name,
+ *                             float *amount ) 
+ * Parameters: report - budget report being read
+ *             line - reusable buffer to read the line into
+ *             name - set to the category name, which points into line
+ *             amount - set to the amount spent in the category
+ * Description: reads the next category line of a report. Names may contain
+ *              spaces, so the name is everything before the last dollar sign
+ * Return: 1 if a category was read, 0 at the end of the categories, -1 if
+ *         the line is not a category
+ * Error Conditions: line is missing a name or an amount
+ */
+int readCategoryLine( FILE *report, char *line, char **name, float *amount ) {
+  char *dollarSign;
+  char *nameEnd;
+  char *endPtr;
+
+  // categories end at the blank line before the total
+  if( readLine( line, report ) != 0 || line[0] == '\0' ) {
+    return 0;
+  }
+
+  dollarSign = strrchr( line, (int) '$' );
+  if( dollarSign == NULL ) {
+    return -1;
+  }
+
+  // strip the padding between name and amount
+  nameEnd = dollarSign;
+  while( nameEnd > line && *(nameEnd - 1) == ' ' ) {
+    nameEnd--;
+  }
+  if( nameEnd == line ) {
+    return -1;
+  }
+
+  *amount = strtof( dollarSign + 1, &endPtr );
+  if( endPtr == dollarSign + 1 ) {
+    return -1;
+  }
+
+  *nameEnd = '\0';
+  *name = line;
+
+  return 1;
+}
+
+/**
+ * Function: loadCategories( FILE *report, struct CategoryStore *store,
+ *                           double *total, char *line ) 
+ * Parameters: report - budget report to load, already past its header
+ *             store - store to record the categories in
+ *             total - set to the sum of every category, kept in double so
+ *                     long reports do not lose cents
+ *             line - reusable buffer to read each line of the report into
+ * Description: reads the remaining categories of a report into a store
+ * Return: 0 if successful, -1 if not
+ * Error Conditions: report not in correct format, no more memory
+ */
+int loadCategories( FILE *report, struct CategoryStore *store, double *total,
+                    char *line ) {
+  char *name;
+  float amount;
+  int status;
+
+  *total = 0;
+  while( (status = readCategoryLine( report, line, &name, &amount )) == 1 ) {
+    if( storeAdd( store, name, amount ) == -1 ) {
+      fprintf( stdout, NO_MEM ); 
+      return -1;
+    }
+    *total += amount;
+  }
+
+  return status;
+}
+
+/**
+ * Function: loadReport( FILE *report, struct CategoryStore *store,
+ *                       double *total, char *line ) 
+ * Parameters: report - budget report to load
+ *             store - store to record the categories in
+ *             total - set to the sum of every category
+ *             line - reusable buffer to read each line of the report into
+ * Description: reads every category of a report into a store
+ * Return: 0 if successful, -1 if not
+ * Error Conditions: report not in correct format, no more memory
+ */
+int loadReport( FILE *report, struct CategoryStore *store, double *total,
+                char *line ) {
+  if( readHeader( report, line ) != 0 ) {
+    return -1;
+  }
+
+  return loadCategories( report, store, total, line );
+}
+
+/**
+ * Function: reportIsSorted( FILE *report, char *line, char *prevName ) 
+ * Parameters: report - budget report to check, rewound afterwards
+ *             line - reusable buffer to read each line of the report into
+ *             prevName - buffer of BUFSIZ bytes to hold the previous name
+ * Description: checks whether the categories of a report are in order by
+ *              name, with any repeated name on consecutive lines. The whole
+ *              report is read so that a malformed line is found before
+ *              anything is printed
+ * Return: 1 if sorted, 0 if not, -1 if the report is malformed
+ * Error Conditions: report not in correct format
+ */
+int reportIsSorted( FILE *report, char *line, char *prevName ) {
+  char *name;
+  float amount;
+  int status = 1;
+  int sorted = 1;
+
+  prevName[0] = '\0';
+  if( readHeader( report, line ) != 0 ) {
+    status = -1;
+  }
+
+  while( status == 1 && 
+         (status = readCategoryLine( report, line, &name, &amount )) == 1 ) {
+    if( sorted && strcmp( prevName, name ) > 0 ) {
+      sorted = 0;
+    } else if( sorted ) {
+      strcpy( prevName, name );
+    }
+  }
+
+  rewind( report );
+  return status == -1 ? -1 : sorted;
+}
+
+/**
+ * Function: printDelta( FILE *stream, const char *name, double oldAmount,
+ *                       double newAmount, const char *tag ) 
+ * Parameters: stream - where the line should be outputted
+ *             name - name of the category
+ *             oldAmount - amount spent in the old report
+ *             newAmount - amount spent in the new report
+ *             tag - shown in place of the percentage change, or NULL
+ * Description: prints how much a category changed between two reports
+ * Return: void
+ * Error Conditions: none
+ */
+void printDelta( FILE *stream, const char *name, double oldAmount, 
+                 double newAmount, const char *tag ) {
+  char percent[PERCENT_SIZE];
+
+  // percentage change is undefined if nothing was spent before
+  if( tag == NULL ) {
+    if( oldAmount == 0 ) {
+      tag = DIFF_NO_PERCENT;
+    } else {
+      snprintf( percent, PERCENT_SIZE, FORMAT_PERCENT, 
+                ((newAmount - oldAmount) / oldAmount) * 100 );
+      tag = percent;
+    }
+  }
+
+  fprintf( stream, FORMAT_DIFF, name, oldAmount, newAmount, 
+           newAmount - oldAmount, tag );
 }
 
 /**
- * Function: freeMemory( int categoryCount, struct Category *catArray[] ) 
- * Parameters: categoryCount - the number of categories recorded
- *             catArray - the array of categories
- * Description: frees all memory allocated to category array starting with
- * category names and then the struct categories themselves 
+ * Function: printDiffHeader( char *oldFile, char *newFile ) 
+ * Parameters: oldFile - filename of the earlier budget report
+ *             newFile - filename of the later budget report
+ * Description: prints the separator and column names that begin a comparison
  * Return: void
  * Error Conditions: none
  */
-void freeMemory( int categoryCount, struct Category *catArray[] ) {
+void printDiffHeader( char *oldFile, char *newFile ) {
+  fprintf( stdout, "%s%s", "\n", FORMAT_SEP ); 
+  fprintf( stdout, FORMAT_DIFF_HEADER, oldFile, newFile ); 
+  fprintf( stdout, FORMAT_DIFF_COLUMNS, "CATEGORY", "OLD", "NEW", "CHANGE",
+           "PERCENT" ); 
+}
+
+/**
+ * Function: cursorNext( struct ReportCursor *cursor ) 
+ * Parameters: cursor - cursor to advance
+ * Description: moves to the next name in the report, adding up every
+ *              consecutive line with that name the same way storeAdd does
+ * Return: void
+ * Error Conditions: none; cursor->status is -1 if the report is malformed
+ */
+void cursorNext( struct ReportCursor *cursor ) {
+  if( cursor->lineStatus != 1 ) {
+    cursor->status = cursor->lineStatus;
+    return;
+  }
+
+  strcpy( cursor->name, cursor->lineName );
+  cursor->amount = cursor->lineAmount;
+  cursor->status = 1;
+
+  // the line read ahead is the first one with a different name
+  cursor->lineStatus = readCategoryLine( cursor->report, cursor->line, 
+                                         &cursor->lineName, 
+                                         &cursor->lineAmount );
+  while( cursor->lineStatus == 1 && 
+         strcmp( cursor->lineName, cursor->name ) == 0 ) {
+    cursor->amount += cursor->lineAmount;
+    cursor->lineStatus = readCategoryLine( cursor->report, cursor->line, 
+                                           &cursor->lineName, 
+                                           &cursor->lineAmount );
+  }
+}
+
+/**
+ * Function: cursorInit( struct ReportCursor *cursor, FILE *report,
+ *                       char *line, char *name ) 
+ * Parameters: cursor - cursor to set up
+ *             report - sorted budget report, already past its header
+ *             line - buffer of BUFSIZ bytes to read lines ahead into
+ *             name - buffer of BUFSIZ bytes to hold the current name
+ * Description: starts a cursor on the first category of a report
+ * Return: void
+ * Error Conditions: none; cursor->status is -1 if the report is malformed
+ */
+void cursorInit( struct ReportCursor *cursor, FILE *report, char *line, 
+                 char *name ) {
+  cursor->report = report;
+  cursor->line = line;
+  cursor->name = name;
+  cursor->lineStatus = readCategoryLine( report, line, &cursor->lineName, 
+                                         &cursor->lineAmount );
+  cursorNext( cursor );
+}
+
+/**
+ * Function: mergeReports( FILE *oldReport, FILE *newReport, 
+ *                         double *oldTotal, double *newTotal, char *oldLine,
+ *                         char *newLine, char *oldName, char *newName ) 
+ * Parameters: oldReport, newReport - sorted budget reports to compare, already
+ *                                 past their headers
+ *             oldTotal, newTotal - set to the sum of each report
+ *             oldLine, newLine - reusable buffers, one for each report
+ *             oldName, newName - buffers for the current name of each report
+ * Description: walks both reports side by side, printing each category as it
+ *              is matched so only one name of each report is held at a time.
+ *              Repeated names are added together, as joinReports does
+ * Return: 0 if successful, -1 if not
+ * Error Conditions: report not in correct format
+ */
+int mergeReports( FILE *oldReport, FILE *newReport, double *oldTotal,
+                  double *newTotal, char *oldLine, char *newLine,
+                  char *oldName, char *newName ) {
+  struct ReportCursor oldCursor;
+  struct ReportCursor newCursor;
+  int order;
+
+  *oldTotal = 0;
+  *newTotal = 0;
+
+  cursorInit( &oldCursor, oldReport, oldLine, oldName );
+  cursorInit( &newCursor, newReport, newLine, newName );
+
+  while( oldCursor.status == 1 || newCursor.status == 1 ) {
+    if( oldCursor.status == -1 || newCursor.status == -1 ) {
+      return -1;
+    }
+
+    // the smaller name is missing from the other report
+    if( newCursor.status != 1 ) {
+      order = -1;
+    } else if( oldCursor.status != 1 ) {
+      order = 1;
+    } else {
+      order = strcmp( oldName, newName );
+    }
+
+    if( order < 0 ) {
+      printDelta( stdout, oldName, oldCursor.amount, 0, DIFF_REMOVED );
+    } else if( order > 0 ) {
+      printDelta( stdout, newName, 0, newCursor.amount, DIFF_ADDED );
+    } else {
+      printDelta( stdout, oldName, oldCursor.amount, newCursor.amount, 
+                  NULL );
+    }
+
+    // advance whichever reports were just printed
+    if( order <= 0 ) {
+      *oldTotal += oldCursor.amount;
+      cursorNext( &oldCursor );
+    }
+    if( order >= 0 ) {
+      *newTotal += newCursor.amount;
+      cursorNext( &newCursor );
+    }
+  }
+
+  return (oldCursor.status == -1 || newCursor.status == -1) ? -1 : 0;
+}
+
+/**
+ * Function: joinReports( char *oldFile, char *newFile, FILE *oldReport,
+ *                        FILE *newReport, double *oldTotal, 
+ *                        double *newTotal, char *line ) 
+ * Parameters: oldFile, newFile - filenames shown in the header
+ *             oldReport, newReport - budget reports to compare, already past
+ *                                 their headers
+ *             oldTotal, newTotal - set to the sum of each report
+ *             line - reusable buffer to read each line of the reports into
+ * Description: loads both reports into hash-indexed stores, then prints the
+ *              header, the old report's categories in order and the added
+ *              ones. Each report is read once, so pipes work, and nothing is
+ *              printed unless both load
+ * Return: 0 if successful, -1 if not
+ * Error Conditions: report not in correct format, no more memory
+ */
+int joinReports( char *oldFile, char *newFile, FILE *oldReport, 
+                 FILE *newReport, double *oldTotal, double *newTotal, 
+                 char *line ) {
+  struct CategoryStore oldStore;
+  struct CategoryStore newStore;
+  int status = -1;
   int i;
-  
-  for( i = 0; i < categoryCount; i++ ) { 
-    free( catArray[i]->name );
-    free( catArray[i] ); 
+  int match;
+
+  if( storeInit( &oldStore ) != 0 ) {
+    fprintf( stdout, NO_MEM ); 
+    return -1;
   }
+  if( storeInit( &newStore ) != 0 ) {
+    fprintf( stdout, NO_MEM ); 
+    storeFree( &oldStore );
+    return -1;
+  }
+
+  if( loadCategories( oldReport, &oldStore, oldTotal, line ) == 0 &&
+      loadCategories( newReport, &newStore, newTotal, line ) == 0 ) {
+    printDiffHeader( oldFile, newFile );
+
+    // changed and removed categories
+    for( i = 0; i < oldStore.count; i++ ) {
+      match = storeFind( &newStore, storeName( &oldStore, i ) );
+      if( match == -1 ) {
+        printDelta( stdout, storeName( &oldStore, i ), 
+                    oldStore.amounts[i], 0, DIFF_REMOVED );
+      } else {
+        printDelta( stdout, storeName( &oldStore, i ), 
+                    oldStore.amounts[i], newStore.amounts[match], NULL );
+      }
+    }
+
+    // added categories
+    for( i = 0; i < newStore.count; i++ ) {
+      if( storeFind( &oldStore, storeName( &newStore, i ) ) == -1 ) {
+        printDelta( stdout, storeName( &newStore, i ), 0, 
+                    newStore.amounts[i], DIFF_ADDED );
+      }
+    }
+
+    status = 0;
+  }
+
+  storeFree( &oldStore );
+  storeFree( &newStore );
+  return status;
+}
+
+/**
+ * Function: diffReports( char *oldFile, char *newFile ) 
+ * Parameters: oldFile - filename of the earlier budget report
+ *             newFile - filename of the later budget report
+ * Description: prints the change in each category between two reports,
+ *              along with categories added and removed. Sorted reports are
+ *              merged as they are read; otherwise both are loaded and joined.
+ *              Reports that cannot be rewound, such as pipes, cannot be
+ *              checked for order up front and so are always joined. Nothing
+ *              is printed unless both reports are valid
+ * Return: EXIT_SUCCESS if successful, EXIT_FAILURE if not
+ * Error Conditions: file does not exist, not in correct format, not sorted
+ *                   and cannot be rewound
+ */
+int diffReports( char *oldFile, char *newFile ) {
+  char oldLine[BUFSIZ];
+  char newLine[BUFSIZ];
+  char oldName[BUFSIZ];
+  char newName[BUFSIZ];
+  double oldTotal;
+  double newTotal;
+  int status = 0;
+  int seekable;
+  int oldSorted = 0;
+  int newSorted = 0;
+  FILE *oldReport = fopen( oldFile, FILE_READ );
+  FILE *newReport = fopen( newFile, FILE_READ );
+
+  if( oldReport == NULL || newReport == NULL ) {
+    fprintf( stdout, "%s\n", NO_FILE );
+    if( oldReport != NULL ) {
+      fclose( oldReport );
+    }
+    if( newReport != NULL ) {
+      fclose( newReport );
+    }
+    return EXIT_FAILURE;
+  }
+
+  // the sortedness prescan needs to read each report twice, and checks the
+  // whole of each report before anything is printed
+  seekable = fseek( oldReport, 0, SEEK_SET ) == 0 && 
+             fseek( newReport, 0, SEEK_SET ) == 0;
+  if( seekable ) {
+    oldSorted = reportIsSorted( oldReport, oldLine, oldName );
+    newSorted = reportIsSorted( newReport, oldLine, oldName );
+  }
+
+  if( oldSorted == -1 || newSorted == -1 || 
+      readHeader( oldReport, oldLine ) != 0 || 
+      readHeader( newReport, newLine ) != 0 ) {
+    status = -1;
+
+  // the prescan already checked both sorted reports in full
+  } else if( oldSorted && newSorted ) {
+    printDiffHeader( oldFile, newFile );
+    status = mergeReports( oldReport, newReport, &oldTotal, &newTotal, 
+                           oldLine, newLine, oldName, newName );
+  } else {
+    status = joinReports( oldFile, newFile, oldReport, newReport, &oldTotal,
+                          &newTotal, oldLine );
+  }
+
+  fclose( oldReport );
+  fclose( newReport );
+
+  if( status != 0 ) {
+    fprintf( stderr, BAD_FILE ); 
+    return EXIT_FAILURE;
+  }
+
+  // total change, then end separator
+  fprintf( stdout, "%s", "\n" ); 
+  printDelta( stdout, "TOTAL", oldTotal, newTotal, NULL );
+  fprintf( stdout, "%s%s", FORMAT_SEP, "\n" ); 
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * Function: memoryReport( char *fileName ) 
+ * Parameters: fileName - filename of a budget report to load, or NULL
+ * Description: loads a report and prints how many bytes its categories take
+ *              up, along with what MEM_PROJECTION categories would take
+ * Return: EXIT_SUCCESS if successful, EXIT_FAILURE if not
+ * Error Conditions: file does not exist, not in correct format, no more
+ *                   memory
+ */
+int memoryReport( char *fileName ) {
+  struct CategoryStore store;
+  char line[BUFSIZ];
+  char label[LABEL_SIZE];
+  double total;
+  size_t longBytes = 0;
+  size_t totalBytes;
+  int projected = STORE_INIT_SIZE;
+  int i;
+  FILE *report = NULL;
+
+  if( fileName != NULL ) {
+    report = fopen( fileName, FILE_READ );
+    if( report == NULL ) {
+      fprintf( stdout, "%s\n", NO_FILE );
+      return EXIT_FAILURE;
+    }
+  }
+
+  if( storeInit( &store ) != 0 ) {
+    fprintf( stdout, NO_MEM ); 
+    if( report != NULL ) {
+      fclose( report );
+    }
+    return EXIT_FAILURE;
+  }
+
+  if( report != NULL ) {
+    if( loadReport( report, &store, &total, line ) != 0 ) {
+      fprintf( stderr, BAD_FILE ); 
+      fclose( report );
+      storeFree( &store );
+      return EXIT_FAILURE;
+    }
+    fclose( report );
+  }
+
+  // names too long to keep inline live in their own blocks
+  for( i = 0; i < store.count; i++ ) {
+    if( store.names[i].text[NAME_INLINE] == NAME_LONG ) {
+      longBytes += strlen( store.names[i].heap ) + 1;
+    }
+  }
+  totalBytes = storeBytes( store.capacity ) + longBytes;
+
+  // records double from STORE_INIT_SIZE until they fit
+  while( projected < MEM_PROJECTION ) {
+    projected *= 2;
+  }
+  snprintf( label, LABEL_SIZE, FORMAT_MEM_PROJECTED, MEM_PROJECTION );
+
+  fprintf( stdout, "%s%s", "\n", FORMAT_SEP ); 
+  fprintf( stdout, FORMAT_MEM_HEADER, 
+           fileName != NULL ? fileName : MEM_NO_FILE ); 
+  fprintf( stdout, FORMAT_MEM, "CATEGORIES", (size_t) store.count );
+  fprintf( stdout, FORMAT_MEM, "RECORDS ALLOCATED", (size_t) store.capacity );
+  fprintf( stdout, FORMAT_MEM, "BYTES PER RECORD", 
+           storeBytes( 1 ) - 2 * sizeof(int) );
+  fprintf( stdout, FORMAT_MEM, "INDEX SLOTS", (size_t) store.numSlots );
+  fprintf( stdout, FORMAT_MEM, "LONG NAME BYTES", longBytes );
+  fprintf( stdout, FORMAT_MEM, "TOTAL BYTES", totalBytes );
+  if( store.count > 0 ) {
+    fprintf( stdout, FORMAT_MEM_AVG, "BYTES PER CATEGORY", 
+             (double) totalBytes / store.count );
+  }
+  fprintf( stdout, FORMAT_MEM, label, storeBytes( projected ) );
+  fprintf( stdout, "%s%s", FORMAT_SEP, "\n" ); 
+
+  storeFree( &store );
+  return EXIT_SUCCESS;
 }
 
 /** 
@@ -532,167 +1321,195 @@ int main( int argc, char* argv[] ) {
 
   // for existing spending reports 
   FILE *filePath;
-  struct Category *categories[MAX_CATEGORIES];
-  int numCategories = 0; 
+  struct CategoryStore categories;
   float runningTotal = 0; 
-  char *input = malloc( BUFSIZ ); 
+  double importTotal; 
+  char line[BUFSIZ]; 
   int option;
 
+  // compare two reports instead of running interactively
+  if( argc > 1 && strcmp( argv[1], DIFF_ARG ) == 0 ) {
+    if( argc != DIFF_ARGC ) {
+      fprintf( stderr, "%s\n", USAGE );
+      return EXIT_FAILURE;
+    }
+    return diffReports( argv[2], argv[3] );
+  }
+
+  // report memory use instead of running interactively
+  if( argc > 1 && strcmp( argv[1], MEM_ARG ) == 0 ) {
+    if( argc > MEM_ARGC ) {
+      fprintf( stderr, "%s\n", USAGE );
+      return EXIT_FAILURE;
+    }
+    return memoryReport( argc == MEM_ARGC ? argv[2] : NULL );
+  }
+
   // checks validity of arguments 
   if( usage( argc, argv, &filePath ) == -1 ) {
     fprintf( stderr, "%s\n", USAGE );
     return EXIT_FAILURE;
   }  
 
+  if( storeInit( &categories ) != 0 ) {
+    fprintf( stdout, NO_MEM ); 
+    if( filePath != NULL ) {
+      fclose( filePath );
+    }
+    return EXIT_FAILURE;
+  }
+
   // import information from existing file, print error message and exit
   // otherwise
   if( filePath != NULL ) { 
-    if( readFile( &numCategories, &runningTotal, filePath, categories ) != 0 ) {
+    if( loadReport( filePath, &categories, &importTotal, line ) != 0 ) {
       fprintf( stderr, BAD_FILE ); 
+      storeFree( &categories );
+      fclose( filePath );
       return EXIT_FAILURE;
     } else {
+      runningTotal = (float) importTotal;
       fprintf( stdout, FILE_IMPORTED, argv[1] );  
     }
+    fclose( filePath );
+  }
+
+  // read piped commands ahead in large blocks; a terminal keeps its default
+  // buffering so prompts still appear before each read
+  if( !isatty( fileno( stdin ) ) ) {
+    setvbuf( stdin, readAhead, _IOFBF, READ_AHEAD );
   }
 
   // prompt user and get input
   fprintf( stdout, "%s\n", INIT_PROMPT );
   fprintf( stdout, "%s", PROMPT );
-  fgets( input, BUFSIZ, stdin );
 
-  // while input is valid, do action and prompt again
-  while( input != NULL ) {
+  // while there is input, do action and prompt again
+  while( readLine( line, stdin ) == 0 ) {
 
     // validates input as an option
-    option = validate_options( input ); 
+    option = validate_options( line ); 
 
     // print error message if option not valid
     if( option == -1 ) {
-      fprintf( stdout, NO_OPTION, input );
+      fprintf( stdout, NO_OPTION, line );
 
     // perform necessary command according to option sensei
     } else {
-      int i;
-      struct Category *newCat; 
-      struct Category *exisCat; 
-      char *input; 
-      char *newLine; 
+      int newCat; 
+      int exisCat; 
       FILE *newFile;
 
       switch( option ) {
         case 1: // add spending category 
 
-          newCat = addCategory( numCategories, categories ); 
-          if( newCat == NULL ) {
+          newCat = addCategory( &categories, line ); 
+          if( newCat == -1 ) {
             break; 
           }
 
           // asks user to input spending amount to new category 
-          fprintf( stdout, NEW_AMOUNT, newCat->name ); 
-          askAmount( &runningTotal, newCat, 0 ); 
-
-          // increase number of Categories
-          numCategories++; 
+          fprintf( stdout, NEW_AMOUNT, storeName( &categories, newCat ) ); 
+          askAmount( &runningTotal, &categories.amounts[newCat], 0, line ); 
           break; 
 
         case 2: // add amount to spending category 
-          input = malloc( BUFSIZ ); 
 
           // prompt user 
           fprintf( stdout, FIND_CATEGORY ); 
-          fgets( input, BUFSIZ, stdin ); 
+          if( readLine( line, stdin ) != 0 ) {
+            break;
+          }
 
-          exisCat = findCategory( numCategories, input, categories ); 
-          if( exisCat != NULL ) { 
+          exisCat = findCategory( &categories, line ); 
+          if( exisCat != -1 ) { 
 
             // prompt user to enter an amount 
-            fprintf( stdout, NEW_AMOUNT, exisCat->name ); 
-            askAmount( &runningTotal, exisCat, 0 ); 
+            fprintf( stdout, NEW_AMOUNT, storeName( &categories, exisCat ) ); 
+            askAmount( &runningTotal, &categories.amounts[exisCat], 0, 
+                       line ); 
           } else { 
             fprintf( stdout, NO_CATEGORY ); 
           } 
-
-          free( input ); 
           break;
 
         case 3: // decrease amount to spending category 
-          input = malloc( BUFSIZ ); 
 
           // prompt user 
           fprintf( stdout, FIND_CATEGORY ); 
-          fgets( input, BUFSIZ, stdin ); 
+          if( readLine( line, stdin ) != 0 ) {
+            break;
+          }
 
-          exisCat = findCategory( numCategories, input, categories ); 
-          if( exisCat != NULL ) {
+          exisCat = findCategory( &categories, line ); 
+          if( exisCat != -1 ) {
               
             // prompt user to enter an amount 
-            fprintf( stdout, REM_AMOUNT, exisCat->name ); 
-            askAmount( &runningTotal, exisCat, 1 ); 
+            fprintf( stdout, REM_AMOUNT, storeName( &categories, exisCat ) ); 
+            askAmount( &runningTotal, &categories.amounts[exisCat], 1, 
+                       line ); 
           } else {
             fprintf( stdout, NO_CATEGORY ); 
           }
-
-          free( input ); 
           break; 
 
         case 4: // delete spending category 
-          input = malloc( BUFSIZ ); 
 
           // prompt user 
           fprintf( stdout, REM_CATEGORY ); 
-          fgets( input, BUFSIZ, stdin ); 
+          if( readLine( line, stdin ) != 0 ) {
+            break;
+          }
 
-          exisCat = findCategory( numCategories, input, categories ); 
-          if( exisCat != NULL ) {
-            removeCategory( exisCat, categories, &numCategories, 
-                            &runningTotal ); 
+          exisCat = findCategory( &categories, line ); 
+          if( exisCat != -1 ) {
+            removeCategory( &categories, exisCat, &runningTotal ); 
           } else {
             fprintf( stdout, NO_CATEGORY );
           }
-
-          free( input ); 
           break;
 
         case 5: // view spending report
           
           // error message if there are no categories to print
-          if( numCategories == 0 ) { 
+          if( categories.count == 0 ) { 
             fprintf( stdout, NO_PRINT ); 
 
           // print out data
           } else { 
-            printData( numCategories, runningTotal, categories, stdout ); 
+            printData( &categories, runningTotal, stdout ); 
           }
           break; 
 
         case 6: // export spending report
-          input = malloc( BUFSIZ ); 
 
           // prompt user to enter a filename 
           fprintf( stdout, NEW_FILENAME ); 
-          fgets( input, BUFSIZ, stdin ); 
-
-          // remove newline character from filename 
-          newLine = memchr( input, '\n', BUFSIZ ); 
-          *newLine = '\0'; 
+          if( readLine( line, stdin ) != 0 ) {
+            break;
+          }
 
           // create new file and write report to it
-          newFile = fopen( input, FILE_WRITE );  
-          printData( numCategories, runningTotal, categories, newFile ); 
-
-          free( input );
+          newFile = fopen( line, FILE_WRITE );  
+          if( newFile == NULL ) {
+            fprintf( stdout, NO_EXPORT, line ); 
+            break;
+          }
+          printData( &categories, runningTotal, newFile ); 
+          fclose( newFile );
           break;
           
         case 7: // free all allocated memory and return EXIT_SUCCESS
-          freeMemory( numCategories, categories );
+          storeFree( &categories );
           return EXIT_SUCCESS;
       }
     }
 
     // reprompt
     fprintf( stdout, "%s", PROMPT );
-    fgets( input, BUFSIZ, stdin );
   }
 
+  // out of input, free all allocated memory
+  storeFree( &categories );
   return EXIT_SUCCESS;
 }
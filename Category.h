@@ -1,12 +1,49 @@
 #ifndef CATEGORY_H
 #define CATEGORY_H 
 
+#include <stdio.h>
+
+#define NAME_INLINE 23    // Longest name stored inside a category record
+#define NAME_LONG 1       // Marks a name that had to be stored on the heap
+
+/**
+ * union CategoryName holding a category name in place when it fits, or a
+ * pointer to a heap copy when it does not. text[NAME_INLINE] is always the
+ * terminator of an inline name and is set to NAME_LONG for a heap name
+ */
+union CategoryName {
+  char text[NAME_INLINE + 1];   // inline name, zero padded
+  char *heap;                   // name too long to fit inline
+};
+
+/**
+ * struct CategoryStore holding categories in insertion order as parallel
+ * arrays, with an open-addressed hash index from category name to record
+ */
+struct CategoryStore {
+  union CategoryName *names;  // name of each category
+  float *amounts;             // amount spent in each category
+  unsigned int *hashes;       // hash of each name, checked before names
+  int count;                  // number of records in use
+  int capacity;               // number of records allocated
+  int *slots;                 // index into records for each slot, -1 if empty
+  int numSlots;               // size of slots, always a power of two
+};
+
 /**
- * struct Category with two members 
+ * struct ReportCursor reading a sorted report one category at a time, adding
+ * together consecutive lines that repeat a name
  */
-struct Category { 
-  char *name;
-  float amount; 
+struct ReportCursor {
+  FILE *report;               // report being read
+  char *line;                 // next line of the report, read ahead
+  char *lineName;             // name on the line read ahead, points into line
+  float lineAmount;           // amount on the line read ahead
+  int lineStatus;             // result of reading the line ahead
+  char *name;                 // current name, copied out of line
+  float amount;               // sum of every line with the current name
+  int status;                 // 1 if there is a current name, 0 at the end,
+                              // -1 if the report is malformed
 };
 
 #endif //CATEGORY_H 